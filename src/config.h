@@ -10,3 +10,12 @@
 
 // Delay after launch before querying the Health API
 #define LOAD_DATA_DELAY 500
+
+// Tween the progress ring and goal line when new values arrive
+#define ANIMATE_PROGRESS true
+
+// Duration of a progress tween in milliseconds
+#define TWEEN_DURATION 600
+
+// Upper limit on progress tween redraws per second
+#define TWEEN_MAX_FPS 15
@@ -197,10 +197,9 @@ void graphics_fill_outer_ring(GContext *ctx, int32_t current_steps,
 #endif
 }
 
-void graphics_fill_goal_line(GContext *ctx, int32_t day_average_steps,
+void graphics_fill_goal_line(GContext *ctx, int32_t current_average, int32_t day_average_steps,
                                 int line_length, int line_width, GRect frame, GColor color) {
-  const int current_average = data_get_current_average();
-  if(current_average == 0) {
+  if(current_average == 0 || day_average_steps == 0) {
     // Do not draw
     return;
   }
@@ -0,0 +1,145 @@
+#include "tween.h"
+
+#define FRAME_BUDGET_MS (1000 / TWEEN_MAX_FPS)
+
+// Frame cost is kept in 1/16ths of a millisecond so small costs still register
+#define FRAME_COST_SHIFT 4
+#define FRAME_BUDGET ((int)FRAME_BUDGET_MS << FRAME_COST_SHIFT)
+
+static Layer *s_layer;
+static Animation *s_animation;
+
+static int s_shown_steps, s_shown_average;
+static int s_from_steps, s_from_average;
+static int s_to_steps, s_to_average;
+
+static int s_frame_cost;
+static uint64_t s_last_frame_time;
+
+static int interpolate(int from, int to, AnimationProgress progress) {
+  return from + (int)((int64_t)(to - from) * progress / ANIMATION_NORMALIZED_MAX);
+}
+
+static bool jump_to_end() {
+  const bool changed = s_shown_steps != s_to_steps || s_shown_average != s_to_average;
+  s_shown_steps = s_to_steps;
+  s_shown_average = s_to_average;
+  return changed;
+}
+
+static void update(Animation *animation, const AnimationProgress progress) {
+  if(s_frame_cost > FRAME_BUDGET) {
+    // Frames became too expensive mid-flight, finish with a single redraw
+    if(jump_to_end()) {
+      layer_mark_dirty(s_layer);
+    }
+    animation_unschedule(animation);
+    return;
+  }
+
+  s_shown_steps = interpolate(s_from_steps, s_to_steps, progress);
+  s_shown_average = interpolate(s_from_average, s_to_average, progress);
+
+  // Hold to the frame rate limit, but always draw the final frame
+  const uint64_t now = util_get_time_ms();
+  if(progress < ANIMATION_NORMALIZED_MAX && now - s_last_frame_time < FRAME_BUDGET_MS) {
+    return;
+  }
+  s_last_frame_time = now;
+
+  // The whole window is redrawn, there is no way to redraw just the changed arc
+  layer_mark_dirty(s_layer);
+}
+
+static void stopped(Animation *animation, bool finished, void *context) {
+  // Animations are destroyed by the system once stopped
+  s_animation = NULL;
+
+  if(finished && jump_to_end()) {
+    layer_mark_dirty(s_layer);
+  }
+}
+
+static const AnimationImplementation s_implementation = {
+  .update = update
+};
+
+static bool should_animate() {
+  if(!ANIMATE_PROGRESS) {
+    return false;
+  }
+
+  // Frames that would blow the budget are just a stutter, so jump instead
+  if(s_frame_cost > FRAME_BUDGET) {
+    if(DEBUG) APP_LOG(APP_LOG_LEVEL_DEBUG, "Frame cost %dms over budget",
+                      s_frame_cost >> FRAME_COST_SHIFT);
+    return false;
+  }
+
+  // Nobody is watching the ring while asleep
+  const HealthActivityMask activities = health_service_peek_current_activities();
+  return !(activities & (HealthActivitySleep | HealthActivityRestfulSleep));
+}
+
+void tween_update() {
+  const int steps = data_get_current_steps();
+  const int average = data_get_current_average();
+  if(steps == s_to_steps && average == s_to_average) {
+    // Already shown, or on the way there
+    return;
+  }
+
+  // Start from whatever is on screen now, even if part way through a tween
+  if(s_animation) {
+    animation_unschedule(s_animation);
+  }
+  s_from_steps = s_shown_steps;
+  s_from_average = s_shown_average;
+  s_to_steps = steps;
+  s_to_average = average;
+
+  if(!should_animate()) {
+    jump_to_end();
+    return;
+  }
+
+  s_animation = animation_create();
+  animation_set_duration(s_animation, TWEEN_DURATION);
+  animation_set_curve(s_animation, AnimationCurveEaseOut);
+  animation_set_implementation(s_animation, &s_implementation);
+  animation_set_handlers(s_animation, (AnimationHandlers) {
+    .stopped = stopped
+  }, NULL);
+
+  s_last_frame_time = 0;
+  animation_schedule(s_animation);
+}
+
+void tween_report_frame_cost(int cost_ms) {
+  // Smooth out the odd slow frame, rounding to nearest
+  s_frame_cost = (3 * s_frame_cost + (cost_ms << FRAME_COST_SHIFT) + 2) / 4;
+}
+
+void tween_init(Layer *layer) {
+  s_layer = layer;
+
+  // Nothing to animate from on launch
+  s_to_steps = data_get_current_steps();
+  s_to_average = data_get_current_average();
+  jump_to_end();
+}
+
+void tween_deinit() {
+  if(s_animation) {
+    animation_unschedule(s_animation);
+  }
+  s_layer = NULL;
+}
+
+int tween_get_current_steps() {
+  return s_shown_steps;
+}
+
+int tween_get_current_average() {
+  return s_shown_average;
+}
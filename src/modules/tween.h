@@ -0,0 +1,19 @@
+#pragma once
+
+#include <pebble.h>
+
+#include "../config.h"
+
+#include "data.h"
+#include "util.h"
+
+void tween_init(Layer *layer);
+void tween_deinit();
+
+void tween_update();
+
+void tween_report_frame_cost(int cost_ms);
+
+int tween_get_current_steps();
+
+int tween_get_current_average();
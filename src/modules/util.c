@@ -4,3 +4,10 @@ struct tm* util_get_tm() {
   time_t temp = time(NULL); 
   return localtime(&temp);
 }
+
+uint64_t util_get_time_ms() {
+  time_t seconds;
+  uint16_t millis;
+  time_ms(&seconds, &millis);
+  return (uint64_t)seconds * 1000 + millis;
+}
@@ -3,3 +3,5 @@
 #include <pebble.h>
 
 struct tm* util_get_tm();
+
+uint64_t util_get_time_ms();
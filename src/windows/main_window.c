@@ -5,23 +5,29 @@ static Layer *s_canvas_layer, *s_text_layer;
 
 static char s_current_time_buffer[8];
 
+// When the current frame started, the progress layer is drawn first
+static uint64_t s_frame_start;
+
 static void progress_update_proc(Layer *layer, GContext *ctx) {
+  s_frame_start = util_get_time_ms();
   GRect bounds = layer_get_bounds(layer);
   const int fill_thickness = PBL_IF_RECT_ELSE(12, (180 - grect_inset(bounds, GEdgeInsets(12)).size.h) / 2);
-  int current_steps = data_get_current_steps();
   int daily_average = data_get_daily_average();
-  int current_average = data_get_current_average();
 
-  // Set new exceeded daily average
-  if(current_steps > daily_average) {
-    daily_average = current_steps;
+  // Values on screen, which lag behind the data while a tween runs
+  const int shown_steps = tween_get_current_steps();
+  const int shown_average = tween_get_current_average();
+
+  // Set new exceeded daily average, following the ring so its scale never jumps
+  if(shown_steps > daily_average) {
+    daily_average = shown_steps;
     data_set_daily_average(daily_average);
   }
 
   // Decide color scheme based on progress to/past goal
   GColor scheme_color;
   GBitmap *bitmap;
-  if(current_steps >= current_average) {
+  if(shown_steps >= shown_average) {
     scheme_color  = GColorJaegerGreen;
     bitmap = data_get_green_shoe();
   } else {
@@ -31,8 +37,8 @@ static void progress_update_proc(Layer *layer, GContext *ctx) {
 
   // Perform drawing
   graphics_draw_outer_dots(ctx, bounds);
-  graphics_fill_outer_ring(ctx, current_steps, fill_thickness, bounds, scheme_color);
-  graphics_fill_goal_line(ctx, daily_average, 17, 4, bounds, GColorYellow);
+  graphics_fill_outer_ring(ctx, shown_steps, fill_thickness, bounds, scheme_color);
+  graphics_fill_goal_line(ctx, shown_average, daily_average, 17, 4, bounds, GColorYellow);
   graphics_draw_steps_value(ctx, bounds, scheme_color, bitmap);
 }
 
@@ -70,6 +76,9 @@ static void text_update_proc(Layer *layer, GContext *ctx) {
     graphics_draw_text(ctx, am ? "AM" : "PM", font_med, period_rect, 
                        GTextOverflowModeWordWrap, GTextAlignmentLeft, NULL);
   }
+
+  // The time is drawn last, so this covers every layer in the frame
+  tween_report_frame_cost((int)(util_get_time_ms() - s_frame_start));
 }
 
 /*********************************** Window ***********************************/
@@ -81,6 +90,7 @@ static void window_load(Window *window) {
   s_canvas_layer = layer_create(window_bounds);
   layer_set_update_proc(s_canvas_layer, progress_update_proc);
   layer_add_child(window_layer, s_canvas_layer);
+  tween_init(s_canvas_layer);
 
   GEdgeInsets time_insets = GEdgeInsets(80, 0, 0, 0);
   s_text_layer = layer_create(grect_inset(window_bounds, time_insets));
@@ -89,6 +99,7 @@ static void window_load(Window *window) {
 }
 
 static void window_unload(Window *window) {
+  tween_deinit();
   layer_destroy(s_canvas_layer);
   layer_destroy(s_text_layer);
 
@@ -115,6 +126,7 @@ void main_window_update_time(struct tm* tick_time) {
 
 void main_window_redraw() {
   if(s_canvas_layer && s_text_layer) {
+    tween_update();
     layer_mark_dirty(s_canvas_layer);
     layer_mark_dirty(s_text_layer);
   }
@@ -4,6 +4,7 @@
 
 #include "../modules/data.h"
 #include "../modules/graphics.h"
+#include "../modules/tween.h"
 #include "../modules/util.h"
 
 void main_window_push();
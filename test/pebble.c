@@ -0,0 +1,639 @@
+#include <math.h>
+#include <stdarg.h>
+
+#include "render.h"
+
+#define FNV_OFFSET_BASIS 0xcbf29ce484222325ULL
+#define FNV_PRIME 0x100000001b3ULL
+
+#define ALPHA_MASK 0xC0
+
+#define MAX_ANIMATIONS 4
+
+struct GContext {
+  GColor fill_color;
+  GColor stroke_color;
+  GColor text_color;
+  uint8_t stroke_width;
+  // Layer frame in screen coordinates, everything drawn is offset and clipped to it
+  GRect frame;
+};
+
+struct Window {
+  Layer root_layer;
+  GColor background_color;
+  WindowHandlers handlers;
+};
+
+struct FontInfo {
+  const char *key;
+  int char_width;
+  int line_height;
+};
+
+struct GBitmap {
+  GSize size;
+  // The shoe logos are drawn as a solid block in their own colour
+  GColor color;
+};
+
+struct Animation {
+  bool in_use;
+  bool scheduled;
+  uint32_t duration_ms;
+  uint64_t start_ms;
+  const AnimationImplementation *implementation;
+  AnimationHandlers handlers;
+  void *context;
+};
+
+static const struct FontInfo s_fonts[] = {
+  { FONT_KEY_GOTHIC_18_BOLD, 8, 18 },
+  { FONT_KEY_GOTHIC_24_BOLD, 11, 24 },
+  { FONT_KEY_BITHAM_30_BLACK, 18, 30 }
+};
+
+static uint8_t s_framebuffer[SCREEN_H][SCREEN_W];
+static GColor s_background = GColorWhite;
+static GContext s_ctx;
+static uint64_t s_text_hash;
+static int s_draw_ops;
+static bool s_trace;
+static bool s_24h_style = true;
+static uint64_t s_clock_ms;
+static int s_draw_cost_ms;
+static bool s_dirty;
+static HealthActivityMask s_activities;
+static Animation s_animations[MAX_ANIMATIONS];
+
+/********************************* Rasterizer *********************************/
+
+static uint64_t hash_bytes(uint64_t hash, const void *data, size_t length) {
+  const uint8_t *bytes = data;
+  for(size_t i = 0; i < length; i++) {
+    hash = (hash ^ bytes[i]) * FNV_PRIME;
+  }
+  return hash;
+}
+
+static uint8_t to_screen_color(GColor color) {
+#if defined(PBL_BW)
+  // A 1 bit screen shows white or black, split at mid luminance
+  const int r = (color.argb >> 4) & 0x3;
+  const int g = (color.argb >> 2) & 0x3;
+  const int b = color.argb & 0x3;
+  const int luminance = 299 * r + 587 * g + 114 * b;
+  return luminance * 2 >= 3 * 1000 ? GColorWhite.argb : GColorBlack.argb;
+#else
+  return color.argb;
+#endif
+}
+
+// x and y are in layer coordinates
+static void put_pixel(GContext *ctx, int x, int y, GColor color) {
+  if((color.argb & ALPHA_MASK) == 0 || x < 0 || y < 0 ||
+     x >= ctx->frame.size.w || y >= ctx->frame.size.h) {
+    return;
+  }
+
+  x += ctx->frame.origin.x;
+  y += ctx->frame.origin.y;
+  if(x < 0 || y < 0 || x >= SCREEN_W || y >= SCREEN_H) {
+    return;
+  }
+  s_framebuffer[y][x] = to_screen_color(color);
+}
+
+static void fill_rect(GContext *ctx, GRect rect, GColor color) {
+  for(int y = rect.origin.y; y < rect.origin.y + rect.size.h; y++) {
+    for(int x = rect.origin.x; x < rect.origin.x + rect.size.w; x++) {
+      put_pixel(ctx, x, y, color);
+    }
+  }
+}
+
+static void fill_disc(GContext *ctx, int cx, int cy, int radius, GColor color) {
+  for(int dy = -radius; dy <= radius; dy++) {
+    for(int dx = -radius; dx <= radius; dx++) {
+      if(dx * dx + dy * dy <= radius * radius) {
+        put_pixel(ctx, cx + dx, cy + dy, color);
+      }
+    }
+  }
+}
+
+static void stroke_line(GContext *ctx, GPoint p0, GPoint p1) {
+  // Bresenham, with a round pen for wider strokes
+  const int radius = ctx->stroke_width / 2;
+  int x = p0.x, y = p0.y;
+  const int dx = abs(p1.x - p0.x), step_x = p0.x < p1.x ? 1 : -1;
+  const int dy = -abs(p1.y - p0.y), step_y = p0.y < p1.y ? 1 : -1;
+  int error = dx + dy;
+  while(true) {
+    fill_disc(ctx, x, y, radius, ctx->stroke_color);
+    if(x == p1.x && y == p1.y) {
+      break;
+    }
+    const int error2 = 2 * error;
+    if(error2 >= dy) {
+      error += dy;
+      x += step_x;
+    }
+    if(error2 <= dx) {
+      error += dx;
+      y += step_y;
+    }
+  }
+}
+
+// Counts a draw call, charges its cost to the clock and optionally prints it
+static void draw_call(const char *fmt, ...) {
+  s_draw_ops++;
+  s_clock_ms += s_draw_cost_ms;
+  if(!s_trace) {
+    return;
+  }
+
+  va_list args;
+  va_start(args, fmt);
+  printf("  ");
+  vprintf(fmt, args);
+  printf("\n");
+  va_end(args);
+}
+
+void render_begin_frame() {
+  memset(s_framebuffer, to_screen_color(s_background), sizeof(s_framebuffer));
+  s_text_hash = FNV_OFFSET_BASIS;
+  s_draw_ops = 0;
+}
+
+void render_draw_layer(Layer *layer) {
+  // Drawing state starts afresh for every layer
+  s_ctx = (GContext) {
+    .fill_color = GColorBlack,
+    .stroke_color = GColorBlack,
+    .text_color = GColorBlack,
+    .stroke_width = 1,
+    .frame = layer->frame
+  };
+  if(layer->update_proc) {
+    layer->update_proc(layer, &s_ctx);
+  }
+}
+
+uint64_t render_get_hash() {
+  uint64_t hash = hash_bytes(FNV_OFFSET_BASIS, s_framebuffer, sizeof(s_framebuffer));
+  return hash_bytes(hash, &s_text_hash, sizeof(s_text_hash));
+}
+
+int render_get_draw_ops() {
+  return s_draw_ops;
+}
+
+bool render_write_image(const char *path) {
+  FILE *file = fopen(path, "wb");
+  if(!file) {
+    return false;
+  }
+
+  fprintf(file, "P6\n%d %d\n255\n", SCREEN_W, SCREEN_H);
+  for(int y = 0; y < SCREEN_H; y++) {
+    for(int x = 0; x < SCREEN_W; x++) {
+      const uint8_t argb = s_framebuffer[y][x];
+      const uint8_t rgb[3] = {
+        ((argb >> 4) & 0x3) * 85, ((argb >> 2) & 0x3) * 85, (argb & 0x3) * 85
+      };
+      fwrite(rgb, 1, sizeof(rgb), file);
+    }
+  }
+  fclose(file);
+  return true;
+}
+
+void render_set_trace(bool trace) {
+  s_trace = trace;
+}
+
+void render_set_24h_style(bool is_24h) {
+  s_24h_style = is_24h;
+}
+
+void render_set_time(time_t now) {
+  s_clock_ms = (uint64_t)now * 1000;
+}
+
+static void release_animation(Animation *animation, bool finished) {
+  animation->scheduled = false;
+  if(animation->handlers.stopped) {
+    animation->handlers.stopped(animation, finished, animation->context);
+  }
+  // Destroyed once stopped, as on the watch
+  animation->in_use = false;
+}
+
+void render_advance_ms(int ms) {
+  s_clock_ms += ms;
+  for(int i = 0; i < MAX_ANIMATIONS; i++) {
+    Animation *animation = &s_animations[i];
+    if(!animation->in_use || !animation->scheduled) {
+      continue;
+    }
+
+    const uint64_t elapsed = s_clock_ms - animation->start_ms;
+    const bool done = elapsed >= animation->duration_ms;
+    const AnimationProgress progress = done ? ANIMATION_NORMALIZED_MAX :
+        (AnimationProgress)(elapsed * ANIMATION_NORMALIZED_MAX / animation->duration_ms);
+    animation->implementation->update(animation, progress);
+
+    // The update may have unscheduled the animation itself
+    if(done && animation->in_use && animation->scheduled) {
+      release_animation(animation, true);
+    }
+  }
+}
+
+void render_set_draw_cost_ms(int cost_ms) {
+  s_draw_cost_ms = cost_ms;
+}
+
+bool render_take_dirty() {
+  const bool dirty = s_dirty;
+  s_dirty = false;
+  return dirty;
+}
+
+int render_get_scheduled_animations() {
+  int count = 0;
+  for(int i = 0; i < MAX_ANIMATIONS; i++) {
+    if(s_animations[i].in_use && s_animations[i].scheduled) {
+      count++;
+    }
+  }
+  return count;
+}
+
+void render_set_activities(HealthActivityMask activities) {
+  s_activities = activities;
+}
+
+/********************************* Geometry ***********************************/
+
+GRect grect_inset(GRect rect, GEdgeInsets insets) {
+  return GRect(rect.origin.x + insets.left, rect.origin.y + insets.top,
+               rect.size.w - insets.left - insets.right,
+               rect.size.h - insets.top - insets.bottom);
+}
+
+GPoint gpoint_from_polar(GRect rect, GOvalScaleMode scale_mode, int32_t angle) {
+  // Circle of the largest square centred in rect, angle 0 at the top going clockwise
+  const double side = rect.size.w < rect.size.h ? rect.size.w : rect.size.h;
+  const double radius = (side - 1) / 2;
+  const double center_x = rect.origin.x + (rect.size.w - 1) / 2.0;
+  const double center_y = rect.origin.y + (rect.size.h - 1) / 2.0;
+  const double radians = 2 * M_PI * angle / TRIG_MAX_ANGLE;
+  return GPoint((int16_t)lround(center_x + radius * sin(radians)),
+                (int16_t)lround(center_y - radius * cos(radians)));
+}
+
+/*********************************** Layers ***********************************/
+
+Layer* layer_create(GRect frame) {
+  Layer *layer = calloc(1, sizeof(Layer));
+  layer->frame = frame;
+  layer->bounds = GRect(0, 0, frame.size.w, frame.size.h);
+  return layer;
+}
+
+void layer_destroy(Layer *layer) {
+  free(layer);
+}
+
+GRect layer_get_bounds(const Layer *layer) {
+  return layer->bounds;
+}
+
+void layer_set_update_proc(Layer *layer, LayerUpdateProc update_proc) {
+  layer->update_proc = update_proc;
+}
+
+void layer_add_child(Layer *parent, Layer *child) { }
+
+void layer_mark_dirty(Layer *layer) {
+  if(layer) {
+    s_dirty = true;
+  }
+}
+
+Window* window_create() {
+  Window *window = calloc(1, sizeof(Window));
+  window->root_layer.frame = GRect(0, 0, SCREEN_W, SCREEN_H);
+  window->root_layer.bounds = window->root_layer.frame;
+  window->background_color = GColorWhite;
+  return window;
+}
+
+void window_destroy(Window *window) {
+  free(window);
+}
+
+Layer* window_get_root_layer(const Window *window) {
+  return (Layer*)&window->root_layer;
+}
+
+void window_set_background_color(Window *window, GColor color) {
+  window->background_color = color;
+  s_background = color;
+}
+
+void window_set_window_handlers(Window *window, WindowHandlers handlers) {
+  window->handlers = handlers;
+}
+
+void window_stack_push(Window *window, bool animated) {
+  if(window->handlers.load) {
+    window->handlers.load(window);
+  }
+}
+
+/******************************* Text and fonts *******************************/
+
+GFont fonts_get_system_font(const char *font_key) {
+  for(size_t i = 0; i < ARRAY_LENGTH(s_fonts); i++) {
+    if(strcmp(s_fonts[i].key, font_key) == 0) {
+      return &s_fonts[i];
+    }
+  }
+  return &s_fonts[0];
+}
+
+GSize graphics_text_layout_get_content_size(const char *text, GFont font, GRect box,
+                                            GTextOverflowMode overflow_mode,
+                                            GTextAlignment alignment) {
+  // Fixed advance per character stands in for the real font metrics
+  const int width = (int)strlen(text) * font->char_width;
+  return GSize(width < box.size.w ? width : box.size.w, font->line_height);
+}
+
+bool clock_is_24h_style() {
+  return s_24h_style;
+}
+
+/********************************** Bitmaps ***********************************/
+
+GBitmap* gbitmap_create_with_resource(uint32_t resource_id) {
+  // Both shoe logos are 29x15
+  GBitmap *bitmap = calloc(1, sizeof(GBitmap));
+  bitmap->size = GSize(29, 15);
+  bitmap->color = resource_id == RESOURCE_ID_GREEN_SHOE_LOGO ? GColorJaegerGreen
+                                                              : GColorPictonBlue;
+  return bitmap;
+}
+
+void gbitmap_destroy(GBitmap *bitmap) {
+  free(bitmap);
+}
+
+GRect gbitmap_get_bounds(const GBitmap *bitmap) {
+  return GRect(0, 0, bitmap->size.w, bitmap->size.h);
+}
+
+/********************************** Drawing ***********************************/
+
+void graphics_context_set_fill_color(GContext *ctx, GColor color) {
+  ctx->fill_color = color;
+}
+
+void graphics_context_set_stroke_color(GContext *ctx, GColor color) {
+  ctx->stroke_color = color;
+}
+
+void graphics_context_set_stroke_width(GContext *ctx, uint8_t stroke_width) {
+  ctx->stroke_width = stroke_width;
+}
+
+void graphics_context_set_text_color(GContext *ctx, GColor color) {
+  ctx->text_color = color;
+}
+
+void graphics_fill_circle(GContext *ctx, GPoint p, uint16_t radius) {
+  draw_call("fill_circle %d,%d r%d", p.x, p.y, radius);
+  fill_disc(ctx, p.x, p.y, radius, ctx->fill_color);
+}
+
+void graphics_draw_line(GContext *ctx, GPoint p0, GPoint p1) {
+  draw_call("draw_line %d,%d %d,%d w%d", p0.x, p0.y, p1.x, p1.y, ctx->stroke_width);
+  stroke_line(ctx, p0, p1);
+}
+
+void graphics_fill_radial(GContext *ctx, GRect rect, GOvalScaleMode scale_mode,
+                          uint16_t inset_thickness, int32_t angle_start, int32_t angle_end) {
+  draw_call("fill_radial %d,%d %dx%d t%d %d..%d", rect.origin.x, rect.origin.y, rect.size.w,
+        rect.size.h, inset_thickness, angle_start, angle_end);
+
+  // Ring of the largest circle centred in rect, angles clockwise from the top
+  const double side = rect.size.w < rect.size.h ? rect.size.w : rect.size.h;
+  const double outer = side / 2;
+  const double inner = outer - inset_thickness;
+  const double center_x = rect.origin.x + rect.size.w / 2.0;
+  const double center_y = rect.origin.y + rect.size.h / 2.0;
+  for(int y = rect.origin.y; y < rect.origin.y + rect.size.h; y++) {
+    for(int x = rect.origin.x; x < rect.origin.x + rect.size.w; x++) {
+      const double dx = x + 0.5 - center_x;
+      const double dy = y + 0.5 - center_y;
+      const double distance = sqrt(dx * dx + dy * dy);
+      if(distance > outer || distance < inner) {
+        continue;
+      }
+
+      double radians = atan2(dx, -dy);
+      if(radians < 0) {
+        radians += 2 * M_PI;
+      }
+      const double angle = radians * TRIG_MAX_ANGLE / (2 * M_PI);
+      if(angle >= angle_start && angle <= angle_end) {
+        put_pixel(ctx, x, y, ctx->fill_color);
+      }
+    }
+  }
+}
+
+void gpath_draw_filled(GContext *ctx, GPath *path) {
+  draw_call("gpath_filled n%u", path->num_points);
+
+  // Even-odd scanline fill, sampled at pixel centres
+  for(int y = 0; y < ctx->frame.size.h; y++) {
+    const double scan_y = y + 0.5;
+    double crossings[64];
+    int num_crossings = 0;
+    for(uint32_t i = 0; i < path->num_points && num_crossings < 64; i++) {
+      const GPoint a = path->points[i];
+      const GPoint b = path->points[(i + 1) % path->num_points];
+      if((a.y <= scan_y) != (b.y <= scan_y)) {
+        crossings[num_crossings++] = a.x + (scan_y - a.y) * (b.x - a.x) / (double)(b.y - a.y);
+      }
+    }
+
+    for(int i = 1; i < num_crossings; i++) {
+      for(int j = i; j > 0 && crossings[j - 1] > crossings[j]; j--) {
+        const double swap = crossings[j];
+        crossings[j] = crossings[j - 1];
+        crossings[j - 1] = swap;
+      }
+    }
+
+    for(int i = 0; i + 1 < num_crossings; i += 2) {
+      for(int x = (int)ceil(crossings[i] - 0.5); x + 0.5 < crossings[i + 1]; x++) {
+        put_pixel(ctx, x, y, ctx->fill_color);
+      }
+    }
+  }
+}
+
+void gpath_draw_outline(GContext *ctx, GPath *path) {
+  draw_call("gpath_outline n%u", path->num_points);
+  for(uint32_t i = 0; i < path->num_points; i++) {
+    stroke_line(ctx, path->points[i], path->points[(i + 1) % path->num_points]);
+  }
+}
+
+void graphics_draw_text(GContext *ctx, const char *text, GFont font, GRect box,
+                        GTextOverflowMode overflow_mode, GTextAlignment alignment,
+                        GTextAttributes *text_attributes) {
+  draw_call("draw_text \"%s\" %s %d,%d %dx%d", text, font->key, box.origin.x, box.origin.y,
+        box.size.w, box.size.h);
+
+  // No glyphs, so the text is a block the size of its content, placed as aligned
+  const GSize size = graphics_text_layout_get_content_size(text, font, box, overflow_mode,
+                                                           alignment);
+  GRect ink = GRect(box.origin.x, box.origin.y, size.w, size.h);
+  if(alignment == GTextAlignmentCenter) {
+    ink.origin.x += (box.size.w - size.w) / 2;
+  } else if(alignment == GTextAlignmentRight) {
+    ink.origin.x += box.size.w - size.w;
+  }
+  fill_rect(ctx, ink, ctx->text_color);
+
+  // What the block says is not in the pixels, so it goes into the hash
+  s_text_hash = hash_bytes(s_text_hash, text, strlen(text) + 1);
+  s_text_hash = hash_bytes(s_text_hash, font->key, strlen(font->key) + 1);
+}
+
+void graphics_draw_bitmap_in_rect(GContext *ctx, const GBitmap *bitmap, GRect rect) {
+  draw_call("draw_bitmap %dx%d in %d,%d %dx%d", bitmap->size.w, bitmap->size.h, rect.origin.x,
+        rect.origin.y, rect.size.w, rect.size.h);
+
+  // The bitmap is not stretched, it is clipped to rect
+  rect.size.w = rect.size.w < bitmap->size.w ? rect.size.w : bitmap->size.w;
+  rect.size.h = rect.size.h < bitmap->size.h ? rect.size.h : bitmap->size.h;
+  fill_rect(ctx, rect, bitmap->color);
+}
+
+/********************************* Animation **********************************/
+
+Animation* animation_create() {
+  for(int i = 0; i < MAX_ANIMATIONS; i++) {
+    if(!s_animations[i].in_use) {
+      s_animations[i] = (Animation) { .in_use = true, .duration_ms = 250 };
+      return &s_animations[i];
+    }
+  }
+  return NULL;
+}
+
+bool animation_set_duration(Animation *animation, uint32_t duration_ms) {
+  animation->duration_ms = duration_ms;
+  return true;
+}
+
+bool animation_set_curve(Animation *animation, AnimationCurve curve) {
+  return true;
+}
+
+bool animation_set_implementation(Animation *animation,
+                                  const AnimationImplementation *implementation) {
+  animation->implementation = implementation;
+  return true;
+}
+
+bool animation_set_handlers(Animation *animation, AnimationHandlers handlers, void *context) {
+  animation->handlers = handlers;
+  animation->context = context;
+  return true;
+}
+
+bool animation_schedule(Animation *animation) {
+  animation->scheduled = true;
+  animation->start_ms = s_clock_ms;
+  return true;
+}
+
+bool animation_unschedule(Animation *animation) {
+  if(!animation->in_use || !animation->scheduled) {
+    return false;
+  }
+  release_animation(animation, false);
+  return true;
+}
+
+/****************************** Timers and time *******************************/
+
+AppTimer* app_timer_register(uint32_t timeout_ms, AppTimerCallback callback, void *data) {
+  return NULL;
+}
+
+time_t render_time(time_t *tloc) {
+  const time_t now = (time_t)(s_clock_ms / 1000);
+  if(tloc) {
+    *tloc = now;
+  }
+  return now;
+}
+
+time_t time_start_of_today() {
+  const time_t now = render_time(NULL);
+  return now - (now % SECONDS_PER_DAY);
+}
+
+uint16_t time_ms(time_t *tloc, uint16_t *out_ms) {
+  const uint16_t millis = (uint16_t)(s_clock_ms % 1000);
+  render_time(tloc);
+  if(out_ms) {
+    *out_ms = millis;
+  }
+  return millis;
+}
+
+/********************************** Storage ***********************************/
+
+bool persist_exists(const uint32_t key) {
+  return false;
+}
+
+int32_t persist_read_int(const uint32_t key) {
+  return 0;
+}
+
+int persist_write_int(const uint32_t key, const int32_t value) {
+  return sizeof(int32_t);
+}
+
+/*********************************** Health ***********************************/
+
+HealthServiceAccessibilityMask health_service_metric_averaged_accessible(
+    HealthMetric metric, time_t time_start, time_t time_end, HealthServiceTimeScope scope) {
+  return HealthServiceAccessibilityMaskNotAvailable;
+}
+
+HealthValue health_service_sum_averaged(HealthMetric metric, time_t time_start,
+                                        time_t time_end, HealthServiceTimeScope scope) {
+  return 0;
+}
+
+HealthValue health_service_sum_today(HealthMetric metric) {
+  return 0;
+}
+
+HealthActivityMask health_service_peek_current_activities() {
+  return s_activities;
+}
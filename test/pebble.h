@@ -0,0 +1,319 @@
+#pragma once
+
+// Minimal host stand-in for the Pebble SDK header. Only the calls made by
+// src/ are declared. Draw calls are rasterized by pebble.c, see render.h.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if !defined(SCREEN_W) || !defined(SCREEN_H)
+#error "SCREEN_W and SCREEN_H must be defined by the build"
+#endif
+
+/********************************** Platform **********************************/
+
+#if defined(PBL_RECT)
+#define PBL_IF_RECT_ELSE(if_true, if_false) (if_true)
+#define PBL_IF_ROUND_ELSE(if_true, if_false) (if_false)
+#elif defined(PBL_ROUND)
+#define PBL_IF_RECT_ELSE(if_true, if_false) (if_false)
+#define PBL_IF_ROUND_ELSE(if_true, if_false) (if_true)
+#else
+#error "One of PBL_RECT or PBL_ROUND must be defined"
+#endif
+
+#if defined(PBL_COLOR)
+#define PBL_IF_COLOR_ELSE(if_true, if_false) (if_true)
+#define PBL_IF_BW_ELSE(if_true, if_false) (if_false)
+#elif defined(PBL_BW)
+#define PBL_IF_COLOR_ELSE(if_true, if_false) (if_false)
+#define PBL_IF_BW_ELSE(if_true, if_false) (if_true)
+#else
+#error "One of PBL_COLOR or PBL_BW must be defined"
+#endif
+
+#define ARRAY_LENGTH(array) (sizeof((array)) / sizeof((array)[0]))
+
+#define SECONDS_PER_DAY 86400
+
+/********************************** Logging ***********************************/
+
+typedef enum {
+  APP_LOG_LEVEL_ERROR = 1,
+  APP_LOG_LEVEL_WARNING = 50,
+  APP_LOG_LEVEL_INFO = 100,
+  APP_LOG_LEVEL_DEBUG = 200
+} AppLogLevel;
+
+#define APP_LOG(level, fmt, ...) ((void)(level))
+
+/********************************* Geometry ***********************************/
+
+typedef struct {
+  int16_t x;
+  int16_t y;
+} GPoint;
+
+typedef struct {
+  int16_t w;
+  int16_t h;
+} GSize;
+
+typedef struct {
+  GPoint origin;
+  GSize size;
+} GRect;
+
+typedef struct {
+  int16_t top;
+  int16_t right;
+  int16_t bottom;
+  int16_t left;
+} GEdgeInsets;
+
+#define GPoint(x, y) ((GPoint){(x), (y)})
+#define GSize(w, h) ((GSize){(w), (h)})
+#define GRect(x, y, w, h) ((GRect){{(x), (y)}, {(w), (h)}})
+
+#define GEdgeInsets1(t) ((GEdgeInsets){(t), (t), (t), (t)})
+#define GEdgeInsets2(t, r) ((GEdgeInsets){(t), (r), (t), (r)})
+#define GEdgeInsets3(t, r, b) ((GEdgeInsets){(t), (r), (b), (r)})
+#define GEdgeInsets4(t, r, b, l) ((GEdgeInsets){(t), (r), (b), (l)})
+#define GEdgeInsetsN(_1, _2, _3, _4, NAME, ...) NAME
+#define GEdgeInsets(...) \
+  GEdgeInsetsN(__VA_ARGS__, GEdgeInsets4, GEdgeInsets3, GEdgeInsets2, GEdgeInsets1)(__VA_ARGS__)
+
+GRect grect_inset(GRect rect, GEdgeInsets insets);
+
+#define TRIG_MAX_ANGLE 0x10000
+#define DEG_TO_TRIGANGLE(angle) (((angle) * TRIG_MAX_ANGLE) / 360)
+
+typedef enum {
+  GOvalScaleModeFitCircle,
+  GOvalScaleModeFillCircle
+} GOvalScaleMode;
+
+GPoint gpoint_from_polar(GRect rect, GOvalScaleMode scale_mode, int32_t angle);
+
+/*********************************** Colour ***********************************/
+
+typedef union {
+  uint8_t argb;
+} GColor;
+
+#define GColorBlack ((GColor){0xC0})
+#define GColorWhite ((GColor){0xFF})
+#define GColorDarkGray ((GColor){0xD5})
+#define GColorJaegerGreen ((GColor){0xD9})
+#define GColorPictonBlue ((GColor){0xDB})
+#define GColorYellow ((GColor){0xFC})
+
+/*********************************** Layers ***********************************/
+
+typedef struct GContext GContext;
+typedef struct Layer Layer;
+typedef struct Window Window;
+
+typedef void (*LayerUpdateProc)(Layer *layer, GContext *ctx);
+
+struct Layer {
+  GRect frame;
+  GRect bounds;
+  LayerUpdateProc update_proc;
+};
+
+typedef void (*WindowHandler)(Window *window);
+
+typedef struct {
+  WindowHandler load;
+  WindowHandler appear;
+  WindowHandler disappear;
+  WindowHandler unload;
+} WindowHandlers;
+
+Layer* layer_create(GRect frame);
+void layer_destroy(Layer *layer);
+GRect layer_get_bounds(const Layer *layer);
+void layer_set_update_proc(Layer *layer, LayerUpdateProc update_proc);
+void layer_add_child(Layer *parent, Layer *child);
+void layer_mark_dirty(Layer *layer);
+
+Window* window_create();
+void window_destroy(Window *window);
+Layer* window_get_root_layer(const Window *window);
+void window_set_background_color(Window *window, GColor color);
+void window_set_window_handlers(Window *window, WindowHandlers handlers);
+void window_stack_push(Window *window, bool animated);
+
+/******************************* Text and fonts *******************************/
+
+typedef const struct FontInfo *GFont;
+
+typedef enum {
+  GTextOverflowModeWordWrap,
+  GTextOverflowModeTrailingEllipsis,
+  GTextOverflowModeFill
+} GTextOverflowMode;
+
+typedef enum {
+  GTextAlignmentLeft,
+  GTextAlignmentCenter,
+  GTextAlignmentRight
+} GTextAlignment;
+
+typedef struct GTextAttributes GTextAttributes;
+
+#define FONT_KEY_GOTHIC_18_BOLD "RESOURCE_ID_GOTHIC_18_BOLD"
+#define FONT_KEY_GOTHIC_24_BOLD "RESOURCE_ID_GOTHIC_24_BOLD"
+#define FONT_KEY_BITHAM_30_BLACK "RESOURCE_ID_BITHAM_30_BLACK"
+
+GFont fonts_get_system_font(const char *font_key);
+
+GSize graphics_text_layout_get_content_size(const char *text, GFont font, GRect box,
+                                            GTextOverflowMode overflow_mode,
+                                            GTextAlignment alignment);
+
+bool clock_is_24h_style();
+
+/********************************** Bitmaps ***********************************/
+
+typedef struct GBitmap GBitmap;
+
+enum {
+  RESOURCE_ID_BLUE_SHOE_LOGO = 1,
+  RESOURCE_ID_GREEN_SHOE_LOGO
+};
+
+GBitmap* gbitmap_create_with_resource(uint32_t resource_id);
+void gbitmap_destroy(GBitmap *bitmap);
+GRect gbitmap_get_bounds(const GBitmap *bitmap);
+
+/********************************** Drawing ***********************************/
+
+typedef struct {
+  uint32_t num_points;
+  GPoint *points;
+  int32_t rotation;
+  GPoint offset;
+} GPath;
+
+void graphics_context_set_fill_color(GContext *ctx, GColor color);
+void graphics_context_set_stroke_color(GContext *ctx, GColor color);
+void graphics_context_set_stroke_width(GContext *ctx, uint8_t stroke_width);
+void graphics_context_set_text_color(GContext *ctx, GColor color);
+
+void graphics_fill_circle(GContext *ctx, GPoint p, uint16_t radius);
+void graphics_draw_line(GContext *ctx, GPoint p0, GPoint p1);
+void graphics_fill_radial(GContext *ctx, GRect rect, GOvalScaleMode scale_mode,
+                          uint16_t inset_thickness, int32_t angle_start, int32_t angle_end);
+void gpath_draw_filled(GContext *ctx, GPath *path);
+void gpath_draw_outline(GContext *ctx, GPath *path);
+void graphics_draw_text(GContext *ctx, const char *text, GFont font, GRect box,
+                        GTextOverflowMode overflow_mode, GTextAlignment alignment,
+                        GTextAttributes *text_attributes);
+void graphics_draw_bitmap_in_rect(GContext *ctx, const GBitmap *bitmap, GRect rect);
+
+/********************************* Animation **********************************/
+
+typedef struct Animation Animation;
+
+typedef uint32_t AnimationProgress;
+
+#define ANIMATION_NORMALIZED_MAX 65535
+
+typedef enum {
+  AnimationCurveLinear,
+  AnimationCurveEaseIn,
+  AnimationCurveEaseOut,
+  AnimationCurveEaseInOut
+} AnimationCurve;
+
+typedef void (*AnimationSetupImplementation)(Animation *animation);
+typedef void (*AnimationUpdateImplementation)(Animation *animation,
+                                              const AnimationProgress progress);
+typedef void (*AnimationTeardownImplementation)(Animation *animation);
+
+typedef struct {
+  AnimationSetupImplementation setup;
+  AnimationUpdateImplementation update;
+  AnimationTeardownImplementation teardown;
+} AnimationImplementation;
+
+typedef void (*AnimationStartedHandler)(Animation *animation, void *context);
+typedef void (*AnimationStoppedHandler)(Animation *animation, bool finished, void *context);
+
+typedef struct {
+  AnimationStartedHandler started;
+  AnimationStoppedHandler stopped;
+} AnimationHandlers;
+
+Animation* animation_create();
+bool animation_set_duration(Animation *animation, uint32_t duration_ms);
+bool animation_set_curve(Animation *animation, AnimationCurve curve);
+bool animation_set_implementation(Animation *animation,
+                                  const AnimationImplementation *implementation);
+bool animation_set_handlers(Animation *animation, AnimationHandlers handlers, void *context);
+bool animation_schedule(Animation *animation);
+bool animation_unschedule(Animation *animation);
+
+/****************************** Timers and time *******************************/
+
+typedef struct AppTimer AppTimer;
+typedef void (*AppTimerCallback)(void *data);
+
+AppTimer* app_timer_register(uint32_t timeout_ms, AppTimerCallback callback, void *data);
+
+// Routed through the recorder so every run sees the same clock
+time_t render_time(time_t *tloc);
+#define time(tloc) render_time(tloc)
+
+time_t time_start_of_today();
+uint16_t time_ms(time_t *tloc, uint16_t *out_ms);
+
+/********************************** Storage ***********************************/
+
+bool persist_exists(const uint32_t key);
+int32_t persist_read_int(const uint32_t key);
+int persist_write_int(const uint32_t key, const int32_t value);
+
+/*********************************** Health ***********************************/
+
+typedef enum {
+  HealthMetricStepCount
+} HealthMetric;
+
+typedef enum {
+  HealthServiceTimeScopeOnce,
+  HealthServiceTimeScopeWeekly,
+  HealthServiceTimeScopeDailyWeekdayOrWeekend,
+  HealthServiceTimeScopeDaily
+} HealthServiceTimeScope;
+
+typedef enum {
+  HealthServiceAccessibilityMaskAvailable = 1 << 0,
+  HealthServiceAccessibilityMaskNoPermission = 1 << 1,
+  HealthServiceAccessibilityMaskNotSupported = 1 << 2,
+  HealthServiceAccessibilityMaskNotAvailable = 1 << 3
+} HealthServiceAccessibilityMask;
+
+typedef enum {
+  HealthActivityNone = 0,
+  HealthActivitySleep = 1 << 0,
+  HealthActivityRestfulSleep = 1 << 1,
+  HealthActivityWalk = 1 << 2,
+  HealthActivityRun = 1 << 3
+} HealthActivity;
+
+typedef uint32_t HealthActivityMask;
+typedef int32_t HealthValue;
+
+HealthServiceAccessibilityMask health_service_metric_averaged_accessible(
+    HealthMetric metric, time_t time_start, time_t time_end, HealthServiceTimeScope scope);
+HealthValue health_service_sum_averaged(HealthMetric metric, time_t time_start,
+                                        time_t time_end, HealthServiceTimeScope scope);
+HealthValue health_service_sum_today(HealthMetric metric);
+HealthActivityMask health_service_peek_current_activities();
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <pebble.h>
+
+// Draw calls are rasterized into a SCREEN_W x SCREEN_H framebuffer, in the
+// colours the platform can show. A frame is checked by hashing its pixels,
+// with the draw call count kept as a separate measure of cost.
+
+// Clears the framebuffer to the window background and starts a new frame
+void render_begin_frame();
+
+// Draws a layer the way the window would, offset and clipped to its frame
+void render_draw_layer(Layer *layer);
+
+// Hash of the framebuffer, plus the string and font of each text box drawn
+uint64_t render_get_hash();
+
+int render_get_draw_ops();
+
+// Writes the framebuffer as a binary PPM, for looking at a failing frame
+bool render_write_image(const char *path);
+
+// Print each draw call to stdout as it is made
+void render_set_trace(bool trace);
+
+void render_set_24h_style(bool is_24h);
+
+// Value returned by time(), interpreted as UTC, with no milliseconds
+void render_set_time(time_t now);
+
+// Moves the clock on and steps every scheduled animation to match.
+// Progress is linear in time, animation curves are not modelled.
+void render_advance_ms(int ms);
+
+// How far the clock moves on for each draw call, to give frames a cost
+void render_set_draw_cost_ms(int cost_ms);
+
+// Whether any layer was marked dirty since the last call
+bool render_take_dirty();
+
+int render_get_scheduled_animations();
+
+// Activities reported by health_service_peek_current_activities()
+void render_set_activities(HealthActivityMask activities);
@@ -0,0 +1,453 @@
+// Renders the watchface for a set of progress states and checks each frame
+// against a checked-in baseline. The pixel hash must match exactly and the
+// number of draw calls must not go up. Tweens are then stepped through
+// their frames and checked against the frame budget.
+//
+// Usage: test_render <baseline> [--update] [--trace] [--images <dir>]
+
+#include "render.h"
+
+// Pull in the tween and the layer update procs, whose state is private
+#include "../src/modules/tween.c"
+#include "../src/windows/main_window.c"
+
+#define DAILY_AVERAGE 10000
+#define CURRENT_AVERAGE 4000
+
+// 10:09 on 2016-03-01 UTC
+#define MORNING 1456826940
+// 22:09 on the same day
+#define EVENING (MORNING + 12 * 60 * 60)
+
+#define MAX_CASES 32
+
+// Interval of the animation timer on the watch
+#define TICK_MS 33
+
+typedef struct {
+  const char *name;
+  int current_steps;
+  int current_average;
+  int daily_average;
+  bool is_24h;
+  time_t now;
+  // Tween from these values, checking the frame drawn tween_ms in
+  bool tweening;
+  int from_steps;
+  int from_average;
+  int tween_ms;
+} RenderCase;
+
+typedef struct {
+  const char *name;
+  // Returns why the check failed, or NULL
+  const char* (*run)();
+} Check;
+
+typedef struct {
+  char name[64];
+  uint64_t hash;
+  int draw_ops;
+} Baseline;
+
+static RenderCase s_cases[MAX_CASES];
+static int s_num_cases;
+
+static Baseline s_baseline[MAX_CASES];
+static int s_num_baseline;
+
+static void add_case(const char *name, int current_steps, int current_average,
+                     int daily_average, bool is_24h, time_t now) {
+  s_cases[s_num_cases++] = (RenderCase) {
+    .name = name,
+    .current_steps = current_steps,
+    .current_average = current_average,
+    .daily_average = daily_average,
+    .is_24h = is_24h,
+    .now = now
+  };
+}
+
+static void add_tween_case(const char *name, int from_steps, int from_average,
+                           int current_steps, int current_average, int daily_average,
+                           int tween_ms) {
+  add_case(name, current_steps, current_average, daily_average, true, MORNING);
+  RenderCase *render_case = &s_cases[s_num_cases - 1];
+  render_case->tweening = true;
+  render_case->from_steps = from_steps;
+  render_case->from_average = from_average;
+  render_case->tween_ms = tween_ms;
+}
+
+static void add_cases() {
+  add_case("zero_steps", 0, CURRENT_AVERAGE, DAILY_AVERAGE, true, MORNING);
+
+#if defined(PBL_RECT)
+  // Steps that land exactly on each corner of the screen, as in steps_to_point()
+  const int perimeter = (SCREEN_W + SCREEN_H) * 2;
+  const int corners[4] = {
+    SCREEN_W / 2,
+    SCREEN_W / 2 + SCREEN_H,
+    SCREEN_W / 2 + SCREEN_H + SCREEN_W,
+    SCREEN_W / 2 + 2 * SCREEN_H + SCREEN_W
+  };
+#elif defined(PBL_ROUND)
+  // Steps that land on the diagonals, where a rectangular screen has its corners
+  const int perimeter = 8;
+  const int corners[4] = { 1, 3, 5, 7 };
+#endif
+  static const char *corner_names[4] = {
+    "corner_top_right", "corner_bottom_right", "corner_bottom_left", "corner_top_left"
+  };
+  for(int i = 0; i < 4; i++) {
+    add_case(corner_names[i], DAILY_AVERAGE * corners[i] / perimeter,
+             CURRENT_AVERAGE, DAILY_AVERAGE, true, MORNING);
+  }
+
+  add_case("behind_average", CURRENT_AVERAGE / 2, CURRENT_AVERAGE, DAILY_AVERAGE, true, MORNING);
+  add_case("ahead_of_average", CURRENT_AVERAGE + 2000, CURRENT_AVERAGE, DAILY_AVERAGE,
+           true, MORNING);
+  add_case("over_daily_average", DAILY_AVERAGE + 2000, CURRENT_AVERAGE, DAILY_AVERAGE,
+           true, MORNING);
+  add_case("zero_daily_average", 0, 0, 0, true, MORNING);
+  add_case("clock_12h_am", CURRENT_AVERAGE + 2000, CURRENT_AVERAGE, DAILY_AVERAGE,
+           false, MORNING);
+  add_case("clock_12h_pm", CURRENT_AVERAGE + 2000, CURRENT_AVERAGE, DAILY_AVERAGE,
+           false, EVENING);
+
+  // Health data went away, the goal line is still on its way down to 0
+  add_tween_case("tween_to_zero_daily_average", 0, CURRENT_AVERAGE, 0, 0, 0, 0);
+
+  // Colour stays behind the goal until the ring actually reaches it
+  add_tween_case("tween_past_average", CURRENT_AVERAGE / 2, CURRENT_AVERAGE,
+                 CURRENT_AVERAGE + 2000, CURRENT_AVERAGE, DAILY_AVERAGE, 0);
+  add_tween_case("tween_past_average_midway", CURRENT_AVERAGE / 2, CURRENT_AVERAGE,
+                 CURRENT_AVERAGE + 2000, CURRENT_AVERAGE, DAILY_AVERAGE, TWEEN_DURATION / 2);
+
+  // The ring fills up, then the daily average follows it
+  add_tween_case("tween_past_daily_average_midway", DAILY_AVERAGE - 1000, CURRENT_AVERAGE,
+                 DAILY_AVERAGE + 1000, CURRENT_AVERAGE, DAILY_AVERAGE, TWEEN_DURATION / 2);
+}
+
+/********************************** Helpers ***********************************/
+
+static void draw_frame() {
+  // One frame is every layer in the window, drawn in order
+  render_begin_frame();
+  render_draw_layer(s_canvas_layer);
+  render_draw_layer(s_text_layer);
+}
+
+// Steps animations on, redrawing whenever a layer is dirty as the window
+// would. Returns the number of frames drawn.
+static int run_animations(int duration_ms, int tick_ms) {
+  int frames = 0;
+  for(int elapsed = 0; elapsed < duration_ms; elapsed += tick_ms) {
+    render_advance_ms(tick_ms);
+    if(render_take_dirty()) {
+      draw_frame();
+      frames++;
+    }
+  }
+  return frames;
+}
+
+static void set_data(int current_steps, int current_average, int daily_average) {
+  data_set_daily_average(daily_average);
+  data_set_current_average(current_average);
+  data_set_current_steps(current_steps);
+  data_update_steps_buffer();
+}
+
+// Shows values straight away, with no tween running and no frame cost history
+static void show_now(int current_steps, int current_average, int daily_average) {
+  if(s_animation) {
+    animation_unschedule(s_animation);
+  }
+  s_frame_cost = 0;
+  render_set_draw_cost_ms(0);
+
+  // Asleep, so new values are not tweened
+  render_set_activities(HealthActivitySleep);
+  set_data(current_steps, current_average, daily_average);
+  render_take_dirty();
+}
+
+static void start_tween(int current_steps, int current_average, int daily_average) {
+  render_set_activities(HealthActivityWalk);
+  set_data(current_steps, current_average, daily_average);
+  render_take_dirty();
+}
+
+static uint64_t render_state(int current_steps, int current_average, int daily_average) {
+  show_now(current_steps, current_average, daily_average);
+  draw_frame();
+  return render_get_hash();
+}
+
+static void render_case(const RenderCase *render_case, uint64_t *hash, int *draw_ops) {
+  render_set_time(render_case->now);
+  render_set_24h_style(render_case->is_24h);
+  main_window_update_time(util_get_tm());
+
+  if(render_case->tweening) {
+    show_now(render_case->from_steps, render_case->from_average, render_case->daily_average);
+    start_tween(render_case->current_steps, render_case->current_average,
+                render_case->daily_average);
+    run_animations(render_case->tween_ms, TICK_MS);
+  } else {
+    show_now(render_case->current_steps, render_case->current_average,
+             render_case->daily_average);
+  }
+
+  draw_frame();
+  *hash = render_get_hash();
+  *draw_ops = render_get_draw_ops();
+}
+
+/*********************************** Checks ***********************************/
+
+static const char* check_final_frame() {
+  const uint64_t expected = render_state(CURRENT_AVERAGE + 2000, CURRENT_AVERAGE, DAILY_AVERAGE);
+
+  show_now(CURRENT_AVERAGE / 2, CURRENT_AVERAGE, DAILY_AVERAGE);
+  start_tween(CURRENT_AVERAGE + 2000, CURRENT_AVERAGE, DAILY_AVERAGE);
+  run_animations(TWEEN_DURATION + TICK_MS, TICK_MS);
+
+  if(render_get_scheduled_animations() != 0) {
+    return "animation still scheduled after its duration";
+  }
+  if(render_get_hash() != expected) {
+    return "last frame drawn is not the end state";
+  }
+  return NULL;
+}
+
+static const char* check_throttled() {
+  show_now(CURRENT_AVERAGE / 2, CURRENT_AVERAGE, DAILY_AVERAGE);
+  start_tween(CURRENT_AVERAGE + 2000, CURRENT_AVERAGE, DAILY_AVERAGE);
+
+  // Ticks much faster than the frame rate limit
+  const int frames = run_animations(TWEEN_DURATION + TICK_MS, 10);
+  if(frames > TWEEN_DURATION / FRAME_BUDGET_MS + 1) {
+    return "more frames drawn than TWEEN_MAX_FPS allows";
+  }
+  if(frames < 3) {
+    return "too few frames to be a tween";
+  }
+  return NULL;
+}
+
+static const char* check_over_budget() {
+  const uint64_t expected = render_state(CURRENT_AVERAGE + 2000, CURRENT_AVERAGE, DAILY_AVERAGE);
+
+  show_now(CURRENT_AVERAGE / 2, CURRENT_AVERAGE, DAILY_AVERAGE);
+  start_tween(CURRENT_AVERAGE + 2000, CURRENT_AVERAGE, DAILY_AVERAGE);
+  const uint64_t start = util_get_time_ms();
+
+  // Every frame is now well over the budget, which the estimate catches up with
+  render_set_draw_cost_ms(6);
+  uint64_t stopped_at = 0;
+  for(int tick = 0; tick < 2 * TWEEN_DURATION / TICK_MS && !stopped_at; tick++) {
+    render_advance_ms(TICK_MS);
+    if(render_get_scheduled_animations() == 0) {
+      stopped_at = util_get_time_ms();
+    }
+    if(render_take_dirty()) {
+      draw_frame();
+    }
+  }
+  render_set_draw_cost_ms(0);
+
+  if(!stopped_at || stopped_at - start >= TWEEN_DURATION) {
+    return "tween kept running over budget";
+  }
+  if(render_get_hash() != expected) {
+    return "did not jump to the end state";
+  }
+  return NULL;
+}
+
+static const char* check_daily_average_scale() {
+  show_now(DAILY_AVERAGE - 1000, CURRENT_AVERAGE, DAILY_AVERAGE);
+  start_tween(DAILY_AVERAGE + 1000, CURRENT_AVERAGE, DAILY_AVERAGE);
+  draw_frame();
+
+  // The steps text jumps, but the ring must stay on the old scale
+  if(data_get_daily_average() != DAILY_AVERAGE) {
+    return "daily average raised before the ring reached it";
+  }
+  return NULL;
+}
+
+static const char* check_frame_cost_estimate() {
+  s_frame_cost = 0;
+  for(int i = 0; i < 32; i++) {
+    tween_report_frame_cost(1);
+  }
+  // Estimates settle within 1/16ms of the cost, so round to the nearest ms
+  const int half = 1 << (FRAME_COST_SHIFT - 1);
+  if(((s_frame_cost + half) >> FRAME_COST_SHIFT) != 1) {
+    return "steady 1ms frames do not register";
+  }
+
+  for(int i = 0; i < 32; i++) {
+    tween_report_frame_cost(10);
+  }
+  if(((s_frame_cost + half) >> FRAME_COST_SHIFT) != 10) {
+    return "steady 10ms frames do not settle at 10ms";
+  }
+  s_frame_cost = 0;
+  return NULL;
+}
+
+static const Check s_checks[] = {
+  { "tween_final_frame", check_final_frame },
+  { "tween_throttled", check_throttled },
+  { "tween_over_budget", check_over_budget },
+  { "tween_daily_average_scale", check_daily_average_scale },
+  { "tween_frame_cost_estimate", check_frame_cost_estimate }
+};
+
+static int run_checks() {
+  int failures = 0;
+  for(size_t i = 0; i < ARRAY_LENGTH(s_checks); i++) {
+    render_set_time(MORNING);
+    render_set_24h_style(true);
+    main_window_update_time(util_get_tm());
+
+    const char *reason = s_checks[i].run();
+    if(reason) {
+      printf("FAIL %s: %s\n", s_checks[i].name, reason);
+      failures++;
+    } else {
+      printf("ok   %s\n", s_checks[i].name);
+    }
+  }
+  return failures;
+}
+
+static const Baseline* find_baseline(const char *name) {
+  for(int i = 0; i < s_num_baseline; i++) {
+    if(strcmp(s_baseline[i].name, name) == 0) {
+      return &s_baseline[i];
+    }
+  }
+  return NULL;
+}
+
+static void load_baseline(const char *path) {
+  FILE *file = fopen(path, "r");
+  if(!file) {
+    return;
+  }
+
+  char line[128];
+  while(fgets(line, sizeof(line), file) && s_num_baseline < MAX_CASES) {
+    Baseline *entry = &s_baseline[s_num_baseline];
+    if(line[0] != '#' &&
+       sscanf(line, "%63s %llx %d", entry->name, (unsigned long long*)&entry->hash,
+              &entry->draw_ops) == 3) {
+      s_num_baseline++;
+    }
+  }
+  fclose(file);
+}
+
+static int write_baseline(const char *path, const uint64_t *hashes, const int *draw_ops) {
+  FILE *file = fopen(path, "w");
+  if(!file) {
+    fprintf(stderr, "Could not write %s\n", path);
+    return 1;
+  }
+
+  fprintf(file, "# case pixel_hash draw_ops\n");
+  for(int i = 0; i < s_num_cases; i++) {
+    fprintf(file, "%s %016llx %d\n", s_cases[i].name, (unsigned long long)hashes[i],
+            draw_ops[i]);
+  }
+  fclose(file);
+  printf("Wrote %d cases to %s\n", s_num_cases, path);
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  if(argc < 2) {
+    fprintf(stderr, "Usage: %s <baseline> [--update] [--trace] [--images <dir>]\n", argv[0]);
+    return 2;
+  }
+  const char *baseline_path = argv[1];
+  bool update = false;
+  bool trace = false;
+  const char *image_dir = NULL;
+  for(int i = 2; i < argc; i++) {
+    if(strcmp(argv[i], "--update") == 0) {
+      update = true;
+    } else if(strcmp(argv[i], "--trace") == 0) {
+      trace = true;
+    } else if(strcmp(argv[i], "--images") == 0 && i + 1 < argc) {
+      image_dir = argv[++i];
+    }
+  }
+
+  render_set_trace(trace);
+  setenv("TZ", "UTC", 1);
+  tzset();
+
+  data_init();
+  main_window_push();
+  add_cases();
+
+  uint64_t hashes[MAX_CASES];
+  int draw_ops[MAX_CASES];
+  for(int i = 0; i < s_num_cases; i++) {
+    if(trace) {
+      printf("%s\n", s_cases[i].name);
+    }
+    render_case(&s_cases[i], &hashes[i], &draw_ops[i]);
+
+    if(image_dir) {
+      char path[256];
+      snprintf(path, sizeof(path), "%s/%s.ppm", image_dir, s_cases[i].name);
+      if(!render_write_image(path)) {
+        fprintf(stderr, "Could not write %s\n", path);
+      }
+    }
+  }
+
+  if(update) {
+    return write_baseline(baseline_path, hashes, draw_ops);
+  }
+
+  load_baseline(baseline_path);
+  int failures = run_checks();
+  for(int i = 0; i < s_num_cases; i++) {
+    const Baseline *expected = find_baseline(s_cases[i].name);
+    if(!expected) {
+      printf("FAIL %s: not in %s\n", s_cases[i].name, baseline_path);
+      failures++;
+      continue;
+    }
+
+    bool failed = false;
+    if(draw_ops[i] > expected->draw_ops) {
+      printf("FAIL %s: %d draw ops, baseline allows %d\n", s_cases[i].name, draw_ops[i],
+             expected->draw_ops);
+      failed = true;
+    }
+    if(hashes[i] != expected->hash) {
+      printf("FAIL %s: pixel hash %016llx, baseline %016llx\n", s_cases[i].name,
+             (unsigned long long)hashes[i], (unsigned long long)expected->hash);
+      failed = true;
+    }
+    if(failed) {
+      failures++;
+    } else {
+      printf("ok   %s (%d draw ops)\n", s_cases[i].name, draw_ops[i]);
+    }
+  }
+
+  const int total = s_num_cases + (int)ARRAY_LENGTH(s_checks);
+  printf("%d/%d cases passed against %s\n", total - failures, total, baseline_path);
+  return failures ? 1 : 0;
+}